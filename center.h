@@ -12,45 +12,106 @@
 #define center_h
 
 #include "driver_test2.h"
+#include "network.h"
+#include "metrics.h"
 #include <fstream>
 #define largeNumber 10000
 
+/**
+ * Read drivers input
+ * @param driver, each row is "driverId startZone startTime startPlatform"
+ * @param driverNumber, number of rows to read, fewer if the input ends
+ */
+inline vector<Person> readDrivers (ifstream & driver, int driverNumber) {
+  vector<Person> roster;
+  int driverId;
+  string startZone;
+  int startTime, startPlatform;
+  for ( int i = 0; i < driverNumber; i++ ) {
+    if ( !(driver >> driverId >> startZone >> startTime >> startPlatform) )
+      break;
+    
+    Person person;
+    person.driverId = driverId;
+    person.startZone = startZone;
+    person.startTime = startTime;
+    if (startPlatform == 0)
+      person.startPlatform = "both";
+    else if (startPlatform == 1)
+      person.startPlatform = "uber";
+    else
+      person.startPlatform = "lyft";
+    
+    roster.push_back(person);
+  }
+  return roster;
+}
+
+/**
+ * Read one request in the requests file format
+ * @param infile, each row is
+ *    "origin destination rating requestTime platform isPool surgePrice"
+ * @param params, request information to fill
+ * @return boolean, false at the end of the input
+ */
+inline bool readRequest (ifstream & infile, Param & params) {
+  int platform;
+  if ( !(infile >> params.origin >> params.destination >> params.rating
+         >> params.requestTime >> platform >> params.isPool
+         >> params.surgePrice) )
+    return false;
+  
+  if (platform == 1 || platform == 2) params.platform = "uber";
+  else params.platform = "lyft";
+  params.accessTime = 0;
+  params.travelTime = 0;
+  return true;
+}
+
 class Center {
 public:
   /**
    * Store travel time and drivers input
    */
-  Center (ifstream & TT, ifstream & driver, int driverNumber) {
-
-    string key;
-    double value;
-    int n;
-    TT >> n;
-    for ( int i = 0; i < n; i++ ) {
-      TT >> key >> value;
-      TravelTime[key] = value;
-    }
-    
-    int driverId;
-    string startZone;
-    int startTime, startPlatform;
-    for ( int i = 0; i < driverNumber; i++ ) {
-      driver >> driverId >> startZone >> startTime >> startPlatform;
-      
-      Person person;
-      person.driverId = driverId;
-      person.startZone = startZone;
-      person.startTime = startTime;
-      if (startPlatform == 0)
-        person.startPlatform = "both";
-      else if (startPlatform == 1)
-        person.startPlatform = "uber";
-      else
-        person.startPlatform = "lyft";
-      
-      Driver driverAgent(person);
-      drivers.push_back(driverAgent);
-    }
+  Center (ifstream & TT, ifstream & driver, int driverNumber)
+  : ownNetwork(TT), network(&ownNetwork),
+    roster(readDrivers(driver, driverNumber)) {
+    buildDrivers(Behavior());
+  }
+  
+  /**
+   * Share a travel time provider loaded elsewhere
+   * @param sharedNetwork, must outlive this object
+   * @param roster, drivers input, the first driverNumber are used
+   */
+  Center (const TravelTimeProvider & sharedNetwork, const vector<Person> & roster,
+          int driverNumber, Behavior behavior = Behavior())
+  : network(&sharedNetwork),
+    roster(roster.begin(),
+           roster.begin() + min<size_t>(driverNumber, roster.size())) {
+    buildDrivers(behavior);
+  }
+  
+  // network may point at ownNetwork, so a copy would share the source's
+  Center (const Center &) = delete;
+  Center & operator= (const Center &) = delete;
+  
+  /**
+   * Restore the initial state in place to run another scenario without
+   * reading the input files or allocating drivers again
+   * @param driverNumber, number of drivers in the scenario, at most the
+   *    number given to the constructor
+   * @param behavior, switches for the next scenario
+   */
+  void reset ( int driverNumber, const Behavior & behavior = Behavior() ) {
+    if ( driverNumber > roster.size() ) driverNumber = roster.size();
+    for ( int i = 0; i < driverNumber; i++ )
+      drivers[i].reset(roster[i], behavior);
+    this->behavior = behavior;
+    this->activeDrivers = driverNumber;
+    this->metrics.reset(driverNumber);
+    this->failureCount = 0;
+    this->assignmentCount = 0;
   }
   
   /**
@@ -59,26 +120,33 @@ public:
    * Should update the driver information
    * @param origin, origin of request to calculate access time
    * @param reqTime, to check driver avaliable
-   * @param Param, the request information
+   * @param Param, the request information, travel and access time are
+   *    filled from the network
    * @return boolean, true if a request can be servered
    */
   bool assignRequest ( Param params, int driverNumber ) {
+    params.travelTime = network->lookup( params.origin, params.destination );
     pair<int, double> nextDriver = this->findDriver( params, 0 );
     if ( nextDriver.first == 0 ) {
       // no driver found
       this->failureCount++;
+      metrics.recordRequest( params, network->findZone(params.origin), 0, false );
       return false;
     }
     
     // check driver's response to the request
     params.accessTime = nextDriver.second;
+    int rejectCount = 0;
     while ( !drivers[nextDriver.first - 1].isAccept( params ) &&
            nextDriver.first <= driverNumber ) {
+      rejectCount++;
       nextDriver = this->findDriver( params, nextDriver.first );
       
       if ( nextDriver.first == 0 ) {
         // no driver found
         this->failureCount++;
+        metrics.recordRequest( params, network->findZone(params.origin),
+                               rejectCount, false );
         //cout << "*** Rejected Request ***" << endl;
         //cout << "Orign: " << params.origin << endl;
         //cout << "Destination: " << params.destination << endl;
@@ -86,21 +154,33 @@ public:
         return false;
       }
     }
-    if ( nextDriver.first > drivers.size() ) {
+    if ( nextDriver.first > activeDrivers ) {
       this->failureCount++;
+      metrics.recordRequest( params, network->findZone(params.origin),
+                             rejectCount, false );
       //cout << "*** Rejected Request ***" << endl;
       //cout << "Orign: " << params.origin << endl;
       //cout << "Destination: " << params.destination << endl;
       //cout << params.rating << endl;
       return false;
     }
-    // Find other travel time for relocation
-    params.travel_time_downtown = TravelTime[params.destination + "-" +"10"];
-    params.travel_time_airport = TravelTime[params.destination + "-" + "3"];
-    params.travel_time_home = TravelTime[params.destination + "-"
-    + drivers[nextDriver.first - 1].getStartZone()];
+    // Find other travel time for relocation, only read by relocating drivers
+    if ( behavior.relocate ) {
+      params.travel_time_downtown = network->lookup(params.destination, "10");
+      params.travel_time_airport = network->lookup(params.destination, "3");
+      params.travel_time_home = network->lookup(params.destination,
+      drivers[nextDriver.first - 1].getStartZone());
+    }
     
-    drivers[nextDriver.first - 1].otherInfoUpdate(params);
+    Driver & driver = drivers[nextDriver.first - 1];
+    metrics.recordRequest( params, network->findZone(params.origin),
+                           rejectCount, true );
+    
+    string platform = driver.getCurrentPlatform();
+    driver.otherInfoUpdate(params);
+    if ( driver.getCurrentPlatform() != platform )
+      metrics.recordPlatformSwitch( network->findZone(params.destination),
+                                    driver.getNextAvaliableTime() );
     
     return true;
   }
@@ -132,9 +212,28 @@ public:
    */
   int getFailureCount() { return this->failureCount; }
   int getAssignmentCount() { return this->assignmentCount; }
+  const Metrics & getMetrics() { return this->metrics; } // copy to keep
 private:
-  unordered_map<string, double> TravelTime; // key #node-#node
+  TravelTimeTable ownNetwork; // empty when the network is shared
+  const TravelTimeProvider * network;
+  vector<Person> roster; // drivers input
   vector<Driver> drivers; // all in system drivers
+  int activeDrivers = 0; // drivers in the current scenario
+  Behavior behavior;     // switches of the current scenario
+  Metrics metrics;
+  
+  /**
+   * Build every driver once; reset() reuses them for smaller fleets
+   */
+  void buildDrivers ( const Behavior & behavior ) {
+    drivers.reserve(roster.size());
+    for ( int i = 0; i < roster.size(); i++ )
+      drivers.push_back(Driver(roster[i], behavior));
+    this->behavior = behavior;
+    this->activeDrivers = drivers.size();
+    this->metrics.setZones(&network->getZones());
+    this->metrics.reset(activeDrivers);
+  }
   int failureCount = 0;
   int assignmentCount = 0;
   /**
@@ -147,7 +246,7 @@ private:
     // Loop through drivers vector and keep the minimal access time one
     double minAccessTime = largeNumber, curTime = largeNumber;
     int retId = 0;
-    for ( int i = lastId; i < drivers.size(); i++ ) {
+    for ( int i = lastId; i < activeDrivers; i++ ) {
       // Check driver avaliability
       if ( !drivers[i].getStatus() ) continue;
       //cout <<drivers[i].getCurrentPlatform()<< endl;
@@ -157,9 +256,8 @@ private:
           drivers[i].getRideType() == 2 )
         continue;
       //if ( drivers[i].getNextAvaliableTime() == driverLogOut ) continue;
-      // make key for lookup
-      string key = params.origin + "-" + drivers[i].getCurrentZone();
-      curTime = TravelTime[key];
+      // access time, keyed #origin-#driverZone as in Traveltime2.txt
+      curTime = network->lookup(params.origin, drivers[i].getCurrentZone());
       if ( curTime < minAccessTime ) {
         minAccessTime = curTime;
         retId = i + 1; // driverId starts from 1
@@ -0,0 +1,203 @@
+/**
+ * demand.h
+ * Purpose: generate synthetic requests on the fly, so that large scenarios
+ *    do not need a requests file. Arrivals follow a time-varying Poisson
+ *    process with one rate per origin, destination and hour of day.
+ *
+ * @version 1.0 10/18/2026
+ */
+
+#ifndef demand_h
+#define demand_h
+
+#include "driver_test2.h"
+#include <fstream>
+
+#define hoursPerDay 24
+#define minutesPerHour 60.0
+
+// Default request attributes
+#define defaultUberShare 0.5
+#define defaultPoolShare 0.2
+#define defaultRatingMin 1.0
+#define defaultRatingMax 5.0
+#define defaultSurgeShare 0.0
+#define defaultSurgeMin 1.0
+#define defaultSurgeMax 2.0
+
+class DemandGenerator {
+public:
+  /**
+   * Store Poisson rates
+   * @param rates, first line is the number of rows, then each row is
+   *    "origin destination hour rate" with rate in requests per hour.
+   *    Reading stops early if the input ends.
+   * @param seed, seed of the random number generator
+   */
+  DemandGenerator ( ifstream & rates, unsigned int seed ) {
+    int n = 0, hour;
+    string origin, destination;
+    double rate;
+    vector<double> weights[hoursPerDay];
+    rates >> n;
+    for ( int i = 0; i < n; i++ ) {
+      if ( !(rates >> origin >> destination >> hour >> rate) ) break;
+      if ( hour < 0 || hour >= hoursPerDay || rate <= 0 ) continue;
+
+      int index = findPair( origin, destination );
+      if ( weights[hour].size() <= index )
+        weights[hour].resize( index + 1, 0 );
+      weights[hour][index] += rate;
+    }
+
+    for ( int h = 0; h < hoursPerDay; h++ ) {
+      weights[h].resize( pairs.size(), 0 );
+      totalRate[h] = 0;
+      for ( int i = 0; i < weights[h].size(); i++ )
+        totalRate[h] += weights[h][i];
+      if ( totalRate[h] > 0 )
+        pickPair[h] = discrete_distribution<int>( weights[h].begin(),
+                                                  weights[h].end() );
+    }
+
+    reset( seed );
+  }
+
+  /**
+   * Restart the stream from time 0
+   * @param seed, the same seed always gives the same stream
+   */
+  void reset ( unsigned int seed ) {
+    engine.seed( seed );
+    uniform.reset();
+    for ( int h = 0; h < hoursPerDay; h++ ) pickPair[h].reset();
+    this->currentTime = 0;
+    this->generated = 0;
+  }
+
+  /**
+   * Produce the next request. Travel time and access time are set to 0
+   * here and filled by Center::assignRequest from its network.
+   * @param params, request information to fill
+   * @return boolean, false if the request limit is reached or no
+   *    demand is configured
+   */
+  bool next ( Param & params ) {
+    if ( requestLimit > 0 && generated >= requestLimit ) return false;
+
+    // Piecewise constant rates: when the next arrival falls past the end
+    // of the current hour, restart from the hour boundary
+    int emptyHours = 0;
+    while ( true ) {
+      int hour = (int)(currentTime / minutesPerHour) % hoursPerDay;
+      double hourEnd = (floor(currentTime / minutesPerHour) + 1) * minutesPerHour;
+      if ( totalRate[hour] <= 0 ) {
+        if ( ++emptyHours > hoursPerDay ) return false;
+        currentTime = hourEnd;
+        continue;
+      }
+      emptyHours = 0;
+
+      exponential_distribution<double> gap( totalRate[hour] / minutesPerHour );
+      double arrival = currentTime + gap( engine );
+      if ( arrival >= hourEnd ) {
+        currentTime = hourEnd;
+        continue;
+      }
+      currentTime = arrival;
+
+      const pair<string, string> & od = pairs[pickPair[hour]( engine )];
+      params.origin = od.first;
+      params.destination = od.second;
+      break;
+    }
+
+    params.requestTime = currentTime;
+    params.platform = uniform( engine ) < uberShare ? "uber" : "lyft";
+    params.isPool = uniform( engine ) < poolShare;
+    params.rating = ratingMin + (ratingMax - ratingMin) * uniform( engine );
+    if ( uniform( engine ) < surgeShare )
+      params.surgePrice = surgeMin + (surgeMax - surgeMin) * uniform( engine );
+    else
+      params.surgePrice = 0;
+    params.accessTime = 0;
+    params.travelTime = 0;
+
+    generated++;
+    return true;
+  }
+
+  /**
+   * Setter
+   */
+  void setRequestLimit ( long limit ) { this->requestLimit = limit; }
+  void setPlatformMix ( double uberShare ) { this->uberShare = uberShare; }
+  void setPoolShare ( double poolShare ) { this->poolShare = poolShare; }
+  void setRatingRange ( double ratingMin, double ratingMax ) {
+    this->ratingMin = ratingMin;
+    this->ratingMax = ratingMax;
+  }
+  void setSurge ( double surgeShare, double surgeMin, double surgeMax ) {
+    this->surgeShare = surgeShare;
+    this->surgeMin = surgeMin;
+    this->surgeMax = surgeMax;
+  }
+
+  /**
+   * Getter
+   */
+  bool hasDemand() const { return !pairs.empty(); }
+  long getGenerated() { return this->generated; }
+  double getCurrentTime() { return this->currentTime; }
+
+  /**
+   * Origins and destinations with a rate, in order of first appearance
+   */
+  vector<string> getZones () const {
+    vector<string> zones;
+    unordered_map<string, bool> seen;
+    for ( int i = 0; i < pairs.size(); i++ ) {
+      const string * od[2] = { &pairs[i].first, &pairs[i].second };
+      for ( int j = 0; j < 2; j++ ) {
+        if ( seen[*od[j]] ) continue;
+        seen[*od[j]] = true;
+        zones.push_back( *od[j] );
+      }
+    }
+    return zones;
+  }
+
+private:
+  vector<pair<string, string> > pairs; // all origin-destination pairs
+  unordered_map<string, int> pairIndex; // key #node-#node
+  double totalRate[hoursPerDay];       // requests per hour, all pairs
+  discrete_distribution<int> pickPair[hoursPerDay];
+
+  mt19937 engine;
+  uniform_real_distribution<double> uniform;
+  double currentTime = 0; // minutes
+  long generated = 0;
+  long requestLimit = 0;  // 0, no limit
+
+  double uberShare = defaultUberShare;
+  double poolShare = defaultPoolShare;
+  double ratingMin = defaultRatingMin;
+  double ratingMax = defaultRatingMax;
+  double surgeShare = defaultSurgeShare;
+  double surgeMin = defaultSurgeMin;
+  double surgeMax = defaultSurgeMax;
+
+  /**
+   * Index of an origin-destination pair, added if new
+   */
+  int findPair ( const string & origin, const string & destination ) {
+    string key = origin + "-" + destination;
+    auto it = pairIndex.find( key );
+    if ( it != pairIndex.end() ) return it->second;
+    pairs.push_back( make_pair( origin, destination ) );
+    pairIndex[key] = pairs.size() - 1;
+    return pairs.size() - 1;
+  }
+};
+
+#endif /* demand_h */
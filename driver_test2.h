@@ -17,6 +17,7 @@
 #include <map>                 // map
 #include <unordered_map>       // unordered_map
 #include <vector>              // vector
+#include <random>              // mt19937, must precede the macros below
 
 #define isPunishRejectTimes 0
 #define punishRejectTimes 2
@@ -101,6 +102,15 @@ struct Param {
   double travel_time_airport;
   double travel_time_home;
 };
+// Behaviour switches, defaults from the macros above
+struct Behavior {
+  bool punishReject = isPunishRejectTimes;
+  int punishRejectLimit = punishRejectTimes;
+  bool surgePrice = useSurgePrice;
+  bool relocate = doRelocateChoice;
+  bool stop = doStopChoice;
+  bool platform = doPlatformChoice;
+};
 
 class Driver {
 public:
@@ -109,17 +119,51 @@ public:
    * @param struct Person including driver information
    * @return private data memebers would be initilized
    */
-  Driver(Person people){
+  Driver(Person people, Behavior behavior = Behavior()){
+    this->behavior = behavior;
     this->driverId = people.driverId;
     this->startZone = people.startZone;
     this->currentZone = people.startZone;
     this->startTime = people.startTime;
     this->nextAvailableTime = people.startTime;
-    if (doPlatformChoice) this->currentPlatform = people.startPlatform;
+    if (behavior.platform) this->currentPlatform = people.startPlatform;
     
     init_beta_relocation_choice();
     init_actions();
     init_states_and_rewards();
+    for ( auto it = states.begin(); it != states.end(); ++it )
+      initialStates.push_back(*it);
+  }
+  
+  /**
+   * Restore the state right after construction, reusing the allocated
+   * strings and hash tables
+   * @param struct Person including driver information
+   * @param struct Behavior, switches for the next scenario
+   */
+  void reset(const Person & people, const Behavior & behavior = Behavior()) {
+    this->behavior = behavior;
+    this->driverId = people.driverId;
+    this->startZone = people.startZone;
+    this->currentZone = people.startZone;
+    this->startTime = people.startTime;
+    this->nextAvailableTime = people.startTime;
+    this->currentPlatform = behavior.platform ? people.startPlatform : "both";
+    
+    rejInRow = 0; acSum = 0; rejSum = 0; assignSum = 0;
+    rideType = 0;
+    status = true;
+    relocateCount = 0;
+    stopCount = 0;
+    earnings = 0;
+    t_top = 0;
+    
+    // States added while learning are set back to the value operator[]
+    // would give them, the rest to their initial value
+    for ( auto it = states.begin(); it != states.end(); ++it )
+      it->second = Value();
+    for ( int i = 0; i < initialStates.size(); i++ )
+      states[initialStates[i].first] = initialStates[i].second;
   }
   
   /**
@@ -128,8 +172,8 @@ public:
    */
   bool isAccept ( Param params ) {
     double ans = -1 - 0.5 * (params.accessTime / 10) - 0.4 * params.isPool +
-    2 * params.surgePrice * useSurgePrice + 0.5 * params.rating - 2 * rejInRow * isPunishRejectTimes;
-    if ( ans > 0 || (isPunishRejectTimes && (rejInRow >= punishRejectTimes))) {
+    2 * params.surgePrice * behavior.surgePrice + 0.5 * params.rating - 2 * rejInRow * behavior.punishReject;
+    if ( ans > 0 || (behavior.punishReject && (rejInRow >= behavior.punishRejectLimit))) {
       rejInRow = 0; acSum++; assignSum++;
       
       this->currentZone = params.destination;
@@ -155,14 +199,14 @@ public:
    */
   bool otherInfoUpdate(Param params) {
     // Do stop choice first
-    if (doStopChoice) {
+    if (behavior.stop) {
       if (stopChoice()) return true;
       
     }
-    if (doRelocateChoice) {
+    if (behavior.relocate) {
       relocateChoice(params);
     }
-    if (doPlatformChoice) {
+    if (behavior.platform) {
       platformChoice(params);
       
     }
@@ -197,14 +241,16 @@ public:
     cout << "Total accept: " << getAcSum() << endl;
     cout << "Total reject: " << getRejSum() << endl;
     
-    if (doRelocateChoice) {
+    if (behavior.relocate) {
       cout << "Total relocation counts: " << getRelocateCount() << endl;
     }
-    if (doPlatformChoice) {}
-    if (doStopChoice) {}
+    if (behavior.platform) {}
+    if (behavior.stop) {}
   }
 
 private:
+  Behavior behavior;
+  
   // Fix
   int driverId;
   string startZone;   // home
@@ -407,7 +453,7 @@ private:
         states[s].l = 0;
       } else if (states[s].t < t_top)
         states[s].LEARN = true;
-      cout << "YES" << endl;
+      //cout << "YES" << endl;
     }
     //cout << "NO" << endl;
     return true;
@@ -423,7 +469,7 @@ private:
     actions.push_back("change_to_lyft");
     actions.push_back("loggin_both");
   }
-  int t_top;
+  int t_top = 0;
   
   struct Value {
     float Q;
@@ -435,6 +481,7 @@ private:
   // Connect state and value
   unordered_map<State, Value> states;
   unordered_map<State, float> rewards;
+  vector<pair<State, Value> > initialStates; // restored by reset()
   void init_states_and_rewards() {
     Value value;
     value.Q = 1 / (1-gamma);
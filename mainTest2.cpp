@@ -7,48 +7,47 @@
  */
 
 #include "center.h"
+#include "demand.h"
 #include <fstream>
 #include <cfloat>
 
 #define requestNumber 1000
+#define maxDriverNumber 850
+#define useDemandGenerator 0 // 1, generate requests from demand.txt rates
+#define demandSeed 2017
 
 int main() {
-  for ( int driverNumber = 1; driverNumber < 851; driverNumber++ ) {
-    // Initilize Center object
-    ifstream TT("Traveltime2.txt");
-    ifstream driver("drivers.txt");
-    //Center center(TT, driver);
-    
-    // Get next request
-    ifstream infile("requests.txt");
-    string origin, destination;
-    int platform;
-    double rating, reqTime, sp;
-    bool isPool;
+  // Initilize Center object once with the largest fleet
+  ifstream TT("Traveltime2.txt");
+  ifstream driver("drivers.txt");
+  Center center(TT, driver, maxDriverNumber);
+#if useDemandGenerator
+  ifstream rates("demand.txt");
+  DemandGenerator demand(rates, demandSeed);
+  demand.setRequestLimit(requestNumber);
+#else
+  ifstream infile("requests.txt");
+#endif
+
+  for ( int driverNumber = 1; driverNumber <= maxDriverNumber; driverNumber++ ) {
+    center.reset(driverNumber);
 
-  
-    //cout << "j: " << j << endl;
-    Center center(TT, driver, driverNumber);
+#if useDemandGenerator
+    demand.reset(demandSeed);
+    Param params;
+    while (demand.next(params)) center.assignRequest(params, driverNumber);
+#else
+    // Get next request
+    infile.clear();
+    infile.seekg(0);
+    Param params;
     for ( int i = 0; i < requestNumber; i++ ) {
-      
-      infile >> origin >> destination >> rating >> reqTime >> platform >> isPool >> sp;
-      
-      Param params;
-      params.origin = origin;
-      params.destination = destination;
-      params.rating = rating;
-      params.requestTime = reqTime;
-      
-      if (platform == 1 || platform == 2) params.platform = "uber";
-      else params.platform = "lyft";
-      
-      params.isPool = isPool;
-      params.surgePrice = sp;
+      if ( !readRequest(infile, params) ) break;
       
       // Assign request
       center.assignRequest(params, driverNumber);
-      
     }
+#endif
     
     // Get final report
     center.print();
@@ -0,0 +1,263 @@
+/**
+ * metrics.h
+ * Purpose: online statistics of a simulation run in fixed memory. Keep
+ *    streaming quantiles of access time and rejections per request, and
+ *    counters by request zone and hour of day. The zone table is sized
+ *    once from the zones the network reports as carrying demand; all
+ *    other zones share one bucket. A copy is a snapshot.
+ *
+ * @version 1.0 10/18/2026
+ */
+
+#ifndef metrics_h
+#define metrics_h
+
+#include "driver_test2.h"
+#include <algorithm>
+#include <cstdlib>
+
+#define metricsHours 24
+
+/**
+ * P-square estimate of one quantile (Jain and Chlamtac, 1985).
+ * Five markers, no samples are stored.
+ */
+class P2Quantile {
+public:
+  P2Quantile ( double p = 0.5 ) : p(p) { reset(); }
+
+  void reset () {
+    count = 0;
+    for ( int i = 0; i < 5; i++ ) {
+      q[i] = 0;
+      n[i] = i;
+    }
+    np[0] = 0; np[1] = 2 * p; np[2] = 4 * p; np[3] = 2 + 2 * p; np[4] = 4;
+    dn[0] = 0; dn[1] = p / 2; dn[2] = p; dn[3] = (1 + p) / 2; dn[4] = 1;
+  }
+
+  void add ( double x ) {
+    if ( count < 5 ) {
+      q[count++] = x;
+      if ( count == 5 ) sort(q, q + 5);
+      return;
+    }
+
+    // Find the cell of x and shift the markers above it
+    int k;
+    if ( x < q[0] ) { q[0] = x; k = 0; }
+    else if ( x >= q[4] ) { q[4] = x; k = 3; }
+    else for ( k = 0; k < 3 && x >= q[k + 1]; k++ ) {}
+    for ( int i = k + 1; i < 5; i++ ) n[i]++;
+    for ( int i = 0; i < 5; i++ ) np[i] += dn[i];
+    count++;
+
+    // Move the middle markers toward their desired positions
+    for ( int i = 1; i < 4; i++ ) {
+      double d = np[i] - n[i];
+      if ( (d >= 1 && n[i + 1] - n[i] > 1) || (d <= -1 && n[i - 1] - n[i] < -1) ) {
+        int s = d > 0 ? 1 : -1;
+        double qp = q[i] + (double)s / (n[i + 1] - n[i - 1])
+        * ((n[i] - n[i - 1] + s) * (q[i + 1] - q[i]) / (n[i + 1] - n[i])
+           + (n[i + 1] - n[i] - s) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+        if ( q[i - 1] < qp && qp < q[i + 1] ) q[i] = qp;
+        else q[i] += s * (q[i + s] - q[i]) / (n[i + s] - n[i]);
+        n[i] += s;
+      }
+    }
+  }
+
+  /**
+   * Current estimate, exact while fewer than five values were added
+   */
+  double value () const {
+    if ( count == 0 ) return 0;
+    if ( count < 5 ) {
+      double first[5];
+      int m = 0;
+      for ( ; m < count && m < 5; m++ ) first[m] = q[m];
+      sort(first, first + m);
+      return first[(int)(p * (m - 1) + 0.5)];
+    }
+    return q[2];
+  }
+
+  long getCount () const { return this->count; }
+
+private:
+  double p;
+  long count;
+  double q[5];  // marker heights
+  long n[5];    // marker positions
+  double np[5]; // desired positions
+  double dn[5]; // desired position increments
+};
+
+// Counters for one zone and hour
+struct ZoneHourCount {
+  long requests;
+  long failures;
+  long rejections;
+  long platformSwitches;
+  double busyMinutes; // access plus travel time of accepted requests
+};
+
+class Metrics {
+public:
+  Metrics () { reset(0); }
+
+  /**
+   * Size the zone table, the only allocation of this class
+   * @param zoneNames, demand zones of the network, must outlive this
+   *    object. Other zones share one extra bucket.
+   */
+  void setZones ( const vector<string> * zoneNames ) {
+    this->zoneNames = zoneNames;
+    this->zoneNumber = zoneNames ? zoneNames->size() : 0;
+    counts.assign((zoneNumber + 1) * metricsHours, ZoneHourCount());
+  }
+
+  /**
+   * Clear all statistics
+   * @param driverNumber, fleet size used for utilisation
+   */
+  void reset ( int driverNumber ) {
+    this->driverNumber = driverNumber;
+    this->lastTime = 0;
+    for ( int i = 0; i < 3; i++ ) {
+      accessTime[i] = P2Quantile(quantile(i));
+      rejections[i] = P2Quantile(quantile(i));
+    }
+    fill(counts.begin(), counts.end(), ZoneHourCount());
+    fill(hourTotals, hourTotals + metricsHours, ZoneHourCount());
+  }
+
+  /**
+   * Record the outcome of one request
+   * @param params, the request, access and travel time are used if served
+   * @param zone, number of the origin zone, -1 if unknown
+   * @param rejectCount, number of drivers who rejected it
+   * @param served, true if a driver accepted it
+   */
+  void recordRequest ( const Param & params, int zone, int rejectCount,
+                       bool served ) {
+    int h = hourOf(params.requestTime);
+    ZoneHourCount * count[2] = { &at(zone, h), &hourTotals[h] };
+    for ( int i = 0; i < 2; i++ ) {
+      count[i]->requests++;
+      count[i]->rejections += rejectCount;
+      if ( served )
+        count[i]->busyMinutes += params.accessTime + params.travelTime;
+      else
+        count[i]->failures++;
+    }
+    for ( int i = 0; i < 3; i++ ) rejections[i].add(rejectCount);
+    if ( served )
+      for ( int i = 0; i < 3; i++ ) accessTime[i].add(params.accessTime);
+  }
+
+  /**
+   * Record a driver changing platform after a trip
+   * @param zone, number of the zone, -1 if unknown
+   */
+  void recordPlatformSwitch ( int zone, double time ) {
+    int h = hourOf(time);
+    at(zone, h).platformSwitches++;
+    hourTotals[h].platformSwitches++;
+  }
+
+  /**
+   * Getter
+   * @param i, 0 for the median, 1 for the 90th and 2 for the 99th percentile
+   */
+  double getAccessTime ( int i ) const { return accessTime[i].value(); }
+  double getRejections ( int i ) const { return rejections[i].value(); }
+
+  /**
+   * Sum over zones for one hour of day, hour -1 for the whole run
+   */
+  ZoneHourCount getTotal ( int hour = -1 ) const {
+    if ( hour >= 0 ) return hourTotals[hour];
+    ZoneHourCount total = ZoneHourCount();
+    for ( int h = 0; h < metricsHours; h++ ) add(total, hourTotals[h]);
+    return total;
+  }
+
+  /**
+   * Share of fleet time spent on trips started in an hour of day,
+   * averaged over the days the run covered
+   */
+  double getUtilisation ( int hour ) const {
+    int hoursSeen = (int)(lastTime / 60) + 1;
+    int days = hoursSeen / metricsHours + (hour < hoursSeen % metricsHours);
+    if ( driverNumber == 0 || days == 0 ) return 0;
+    return getTotal(hour).busyMinutes / (driverNumber * 60.0 * days);
+  }
+
+  /**
+   * Printer, quantiles, then one line per hour and per zone with requests
+   */
+  void print ( ostream & out ) const {
+    out << "access time p50/p90/p99: " << getAccessTime(0) << " "
+    << getAccessTime(1) << " " << getAccessTime(2) << endl;
+    out << "rejections p50/p90/p99: " << getRejections(0) << " "
+    << getRejections(1) << " " << getRejections(2) << endl;
+    out << "hour requests failures rejections switches utilisation" << endl;
+    for ( int h = 0; h < metricsHours; h++ ) {
+      ZoneHourCount total = getTotal(h);
+      if ( total.requests == 0 && total.platformSwitches == 0 ) continue;
+      out << h << " " << total.requests << " " << total.failures << " "
+      << total.rejections << " " << total.platformSwitches << " "
+      << getUtilisation(h) << endl;
+    }
+    out << "zone requests failures rejections switches" << endl;
+    for ( int z = 0; z <= zoneNumber; z++ ) {
+      ZoneHourCount total = ZoneHourCount();
+      for ( int h = 0; h < metricsHours; h++ ) add(total, cell(z, h));
+      if ( total.requests == 0 && total.platformSwitches == 0 ) continue;
+      out << (z < zoneNumber ? (*zoneNames)[z] : "other") << " "
+      << total.requests << " " << total.failures << " "
+      << total.rejections << " " << total.platformSwitches << endl;
+    }
+  }
+
+private:
+  int driverNumber;
+  double lastTime; // latest request or switch time, minutes
+  P2Quantile accessTime[3];
+  P2Quantile rejections[3];
+  const vector<string> * zoneNames = NULL;
+  int zoneNumber = 0;
+  vector<ZoneHourCount> counts; // zone major, last zone for all others
+  ZoneHourCount hourTotals[metricsHours]; // sums over zones
+
+  static double quantile ( int i ) { return i == 0 ? 0.5 : i == 1 ? 0.9 : 0.99; }
+
+  static void add ( ZoneHourCount & total, const ZoneHourCount & count ) {
+    total.requests += count.requests;
+    total.failures += count.failures;
+    total.rejections += count.rejections;
+    total.platformSwitches += count.platformSwitches;
+    total.busyMinutes += count.busyMinutes;
+  }
+
+  const ZoneHourCount & cell ( int zone, int hour ) const {
+    return counts[zone * metricsHours + hour];
+  }
+
+  /**
+   * Hour of day of a time, also tracks the run length
+   */
+  int hourOf ( double time ) {
+    if ( time > lastTime ) lastTime = time;
+    int h = (int)(time / 60) % metricsHours;
+    return h < 0 ? 0 : h;
+  }
+
+  ZoneHourCount & at ( int zone, int hour ) {
+    if ( zone < 0 || zone >= zoneNumber ) zone = zoneNumber;
+    return counts[zone * metricsHours + hour];
+  }
+};
+
+#endif /* metrics_h */
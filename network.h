@@ -0,0 +1,97 @@
+/**
+ * network.h
+ * Purpose: store zone to zone travel times. Loaded once and shared, read
+ *    only, by every Center that simulates on the same network.
+ *    See roadGraph.h for networks too large for a full matrix.
+ *
+ * @version 1.0 10/18/2026
+ */
+
+#ifndef network_h
+#define network_h
+
+#include "driver_test2.h"
+#include <fstream>
+
+/**
+ * Lookup interface used by Center for access and relocation times
+ */
+class TravelTimeProvider {
+public:
+  virtual ~TravelTimeProvider () {}
+
+  /**
+   * Travel time between two zones
+   */
+  virtual double lookup ( const string & origin,
+                          const string & destination ) const = 0;
+
+  /**
+   * All zones of the network, numbered by their position
+   */
+  virtual const vector<string> & getZones () const = 0;
+
+  /**
+   * Number of a zone in getZones(), -1 if the zone is unknown
+   */
+  virtual int findZone ( const string & zone ) const = 0;
+};
+
+/**
+ * Full zone to zone matrix
+ */
+class TravelTimeTable : public TravelTimeProvider {
+public:
+  TravelTimeTable () {}
+
+  /**
+   * Store travel time input
+   * @param TT, first line is the number of rows, then each row is
+   *    "#node-#node time". Reading stops early if the input ends.
+   */
+  TravelTimeTable ( ifstream & TT ) {
+    string key;
+    double value;
+    int n = 0;
+    TT >> n;
+    TravelTime.reserve(n);
+    for ( int i = 0; i < n; i++ ) {
+      if ( !(TT >> key >> value) ) break;
+      TravelTime[key] = value;
+      
+      size_t dash = key.find('-');
+      addZone(key.substr(0, dash));
+      if ( dash != string::npos ) addZone(key.substr(dash + 1));
+    }
+  }
+
+  /**
+   * Travel time between two zones, 0 if the pair is unknown
+   */
+  double lookup ( const string & origin,
+                  const string & destination ) const override {
+    auto it = TravelTime.find( origin + "-" + destination );
+    if ( it == TravelTime.end() ) return 0;
+    return it->second;
+  }
+
+  const vector<string> & getZones () const override { return zones; }
+
+  int findZone ( const string & zone ) const override {
+    auto it = zoneIds.find( zone );
+    return it == zoneIds.end() ? -1 : it->second;
+  }
+
+private:
+  unordered_map<string, double> TravelTime; // key #node-#node
+  vector<string> zones;
+  unordered_map<string, int> zoneIds;
+
+  void addZone ( const string & zone ) {
+    if ( zoneIds.count( zone ) ) return;
+    zoneIds[zone] = zones.size();
+    zones.push_back( zone );
+  }
+};
+
+#endif /* network_h */
@@ -0,0 +1,235 @@
+/**
+ * roadGraph.h
+ * Purpose: travel times from a road graph instead of a full zone to zone
+ *    matrix. RoadGraph holds the links and is shared read only. Each
+ *    Center gets its own RoadGraphCache, which computes shortest paths
+ *    from one origin at a time and keeps the most recently used rows.
+ *
+ * @version 1.0 10/18/2026
+ */
+
+#ifndef roadGraph_h
+#define roadGraph_h
+
+#include "network.h"
+#include <list>
+#include <queue>
+
+#define defaultCacheMegabytes 64
+#define unreachableTime 1000000.0
+
+class RoadGraph {
+public:
+  /**
+   * Store road graph input
+   * @param roads, first line is the number of links, then each link is
+   *    "fromNode toNode time", one direction per link. Zones are the nodes
+   *    with the same name.
+   */
+  RoadGraph ( ifstream & roads ) {
+    string from, to;
+    double time;
+    int n = 0;
+    roads >> n;
+    vector<pair<int, pair<int, double> > > links;
+    for ( int i = 0; i < n; i++ ) {
+      if ( !(roads >> from >> to >> time) ) break;
+      links.push_back(make_pair(addNode(from), make_pair(addNode(to), time)));
+    }
+
+    // Compressed adjacency, links out of node i are first[i] to first[i+1]
+    first.assign(nodeNames.size() + 1, 0);
+    for ( int i = 0; i < links.size(); i++ )
+      first[links[i].first + 1]++;
+    for ( int i = 0; i < nodeNames.size(); i++ ) first[i + 1] += first[i];
+    linkTo.resize(links.size());
+    linkTime.resize(links.size());
+    vector<int> next(first.begin(), first.end() - 1);
+    for ( int i = 0; i < links.size(); i++ ) {
+      int k = next[links[i].first]++;
+      linkTo[k] = links[i].second.first;
+      linkTime[k] = links[i].second.second;
+    }
+  }
+
+  /**
+   * Shortest travel time from an origin to every node
+   * @param time, resized to the number of nodes, unreachableTime if
+   *    there is no path
+   */
+  void timesFrom ( int origin, vector<double> & time ) const {
+    time.assign(nodeNames.size(), unreachableTime);
+    priority_queue<pair<double, int>, vector<pair<double, int> >,
+                   greater<pair<double, int> > > heap;
+    time[origin] = 0;
+    heap.push(make_pair(0.0, origin));
+    while ( !heap.empty() ) {
+      double t = heap.top().first;
+      int v = heap.top().second;
+      heap.pop();
+      if ( t > time[v] ) continue;
+      for ( int k = first[v]; k < first[v + 1]; k++ ) {
+        double candidate = t + linkTime[k];
+        if ( candidate < time[linkTo[k]] ) {
+          time[linkTo[k]] = candidate;
+          heap.push(make_pair(candidate, linkTo[k]));
+        }
+      }
+    }
+  }
+
+  /**
+   * Number of a node, -1 if unknown
+   */
+  int findNode ( const string & name ) const {
+    auto it = nodeIds.find(name);
+    return it == nodeIds.end() ? -1 : it->second;
+  }
+
+  /**
+   * Set the zones that carry demand, every other node is reported as an
+   * unknown zone so per-zone statistics stay small
+   * @param names, zone names, those that are not nodes are skipped
+   */
+  void setZones ( const vector<string> & names ) {
+    zones.clear();
+    zoneIds.clear();
+    for ( int i = 0; i < names.size(); i++ ) {
+      if ( findNode(names[i]) < 0 || zoneIds.count(names[i]) ) continue;
+      zoneIds[names[i]] = zones.size();
+      zones.push_back(names[i]);
+    }
+  }
+
+  /**
+   * Number of a zone in getZones(), -1 if it is not a demand zone
+   */
+  int findZone ( const string & name ) const {
+    auto it = zoneIds.find(name);
+    return it == zoneIds.end() ? -1 : it->second;
+  }
+
+  /**
+   * Getter
+   */
+  const vector<string> & getZones() const { return this->zones; }
+  int getNodeCount() const { return nodeNames.size(); }
+  int getLinkCount() const { return linkTo.size(); }
+
+private:
+  vector<string> nodeNames;
+  unordered_map<string, int> nodeIds;
+  vector<int> first;     // per node, index of its first outgoing link
+  vector<int> linkTo;
+  vector<double> linkTime;
+  vector<string> zones; // demand zones, empty unless setZones is called
+  unordered_map<string, int> zoneIds;
+
+  int addNode ( const string & name ) {
+    auto it = nodeIds.find(name);
+    if ( it != nodeIds.end() ) return it->second;
+    nodeNames.push_back(name);
+    nodeIds[name] = nodeNames.size() - 1;
+    return nodeNames.size() - 1;
+  }
+};
+
+/**
+ * LRU cache of shortest path rows over a shared RoadGraph. Not thread
+ * safe, use one per Center.
+ */
+class RoadGraphCache : public TravelTimeProvider {
+public:
+  /**
+   * @param graph, must outlive this object
+   * @param cacheBytes, memory for rows, at least one row is kept
+   */
+  RoadGraphCache ( const RoadGraph & graph,
+                   size_t cacheBytes = (size_t)defaultCacheMegabytes << 20 )
+  : graph(graph) {
+    size_t rowBytes = graph.getNodeCount() * sizeof(double);
+    cacheRows = rowBytes > 0 ? cacheBytes / rowBytes : 1;
+    if ( cacheRows < 1 ) cacheRows = 1;
+  }
+
+  RoadGraphCache (const RoadGraphCache &) = delete;
+  RoadGraphCache & operator= (const RoadGraphCache &) = delete;
+
+  /**
+   * Shortest travel time from origin to destination, 0 if a zone is
+   * unknown like TravelTimeTable, unreachableTime if there is no path.
+   * Rows are kept per origin: Center looks up the request origin to
+   * every driver's zone, and the request destination to the relocation
+   * zones, which is one row each.
+   */
+  double lookup ( const string & origin,
+                  const string & destination ) const override {
+    int o = graph.findNode(origin);
+    int d = graph.findNode(destination);
+    if ( o < 0 || d < 0 ) return 0;
+    return row(o)[d];
+  }
+
+  const vector<string> & getZones () const override { return graph.getZones(); }
+
+  int findZone ( const string & zone ) const override {
+    return graph.findZone(zone);
+  }
+
+  /**
+   * Getter
+   */
+  size_t getCacheRows() const { return this->cacheRows; }
+  long getCacheMisses() const { return this->cacheMisses; }
+
+private:
+  const RoadGraph & graph;
+
+  // Most recent origin first
+  struct Row {
+    vector<double> time;
+    list<int>::iterator position;
+  };
+  size_t cacheRows;
+  mutable list<int> recent;
+  mutable unordered_map<int, Row> rows;
+  mutable int lastOrigin = -1;
+  mutable const vector<double> * lastRow = NULL;
+  mutable long cacheMisses = 0;
+
+  /**
+   * Travel times from an origin to every node, computed on a miss
+   */
+  const vector<double> & row ( int origin ) const {
+    if ( origin == lastOrigin ) return *lastRow;
+
+    auto it = rows.find(origin);
+    if ( it != rows.end() ) {
+      recent.splice(recent.begin(), recent, it->second.position);
+      lastOrigin = origin;
+      lastRow = &it->second.time;
+      return it->second.time;
+    }
+
+    // Reuse the storage of the least recently used row when full
+    cacheMisses++;
+    vector<double> time;
+    if ( rows.size() >= cacheRows ) {
+      auto oldest = rows.find(recent.back());
+      time.swap(oldest->second.time);
+      rows.erase(oldest);
+      recent.pop_back();
+    }
+    graph.timesFrom(origin, time);
+
+    recent.push_front(origin);
+    Row & entry = rows[origin];
+    entry.time.swap(time);
+    entry.position = recent.begin();
+    lastOrigin = origin;
+    lastRow = &entry.time;
+    return entry.time;
+  }
+};
+
+#endif /* roadGraph_h */
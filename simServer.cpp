@@ -0,0 +1,327 @@
+/**
+ * simServer.cpp
+ * Purpose: long running simulation server. Load the network, the drivers
+ *    and the demand rates once, then read one scenario per line from stdin
+ *    and write one result line per finished scenario to stdout.
+ *
+ *    Scenario line: space separated key=value pairs, for example
+ *      id=a1 drivers=300 source=demand requests=5000 seed=7 stop=1
+ *    source is "demand" for generated requests or a requests file path.
+ *    metrics=1 adds the per hour and per zone report, each line starting
+ *    with the scenario id.
+ *    "quit" or the end of input stops reading; scenarios already read,
+ *    running or queued, still run before the server exits.
+ *
+ * @version 1.0 10/18/2026
+ */
+
+#include <sstream>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include "center.h"
+#include "demand.h"
+#include "roadGraph.h"
+
+#define defaultRequestNumber 1000
+#define defaultSeed 2017
+
+// One scenario request
+struct Scenario {
+  string id;
+  int driverNumber = 0;
+  string source = "demand";
+  long requestNumber = defaultRequestNumber;
+  unsigned int seed = defaultSeed;
+  bool printMetrics = false;
+
+  double uberShare = defaultUberShare;
+  double poolShare = defaultPoolShare;
+  double ratingMin = defaultRatingMin;
+  double ratingMax = defaultRatingMax;
+  double surgeShare = defaultSurgeShare;
+  double surgeMin = defaultSurgeMin;
+  double surgeMax = defaultSurgeMax;
+
+  Behavior behavior;
+};
+
+/**
+ * Read a whole value, trailing characters are an error
+ */
+template <typename T>
+bool parseValue ( const string & text, T & value ) {
+  istringstream in(text);
+  return (in >> value) && (in >> ws).eof();
+}
+
+/**
+ * Parse a scenario line
+ * @param line, key=value pairs
+ * @param scenario, filled from the line, unknown keys are errors
+ * @param error, reason if the line is rejected
+ * @return boolean, true if the line is a valid scenario
+ */
+bool parseScenario ( const string & line, Scenario & scenario, string & error ) {
+  istringstream in(line);
+  string token;
+  while ( in >> token ) {
+    size_t eq = token.find('=');
+    if ( eq == string::npos ) {
+      error = "expected key=value: " + token;
+      return false;
+    }
+    string key = token.substr(0, eq);
+    string text = token.substr(eq + 1);
+    bool ok = true;
+    if ( key == "id" ) ok = parseValue(text, scenario.id);
+    else if ( key == "drivers" ) ok = parseValue(text, scenario.driverNumber);
+    else if ( key == "source" ) ok = parseValue(text, scenario.source);
+    else if ( key == "requests" ) ok = parseValue(text, scenario.requestNumber);
+    else if ( key == "seed" ) ok = parseValue(text, scenario.seed);
+    else if ( key == "metrics" ) ok = parseValue(text, scenario.printMetrics);
+    else if ( key == "uberShare" ) ok = parseValue(text, scenario.uberShare);
+    else if ( key == "poolShare" ) ok = parseValue(text, scenario.poolShare);
+    else if ( key == "ratingMin" ) ok = parseValue(text, scenario.ratingMin);
+    else if ( key == "ratingMax" ) ok = parseValue(text, scenario.ratingMax);
+    else if ( key == "surgeShare" ) ok = parseValue(text, scenario.surgeShare);
+    else if ( key == "surgeMin" ) ok = parseValue(text, scenario.surgeMin);
+    else if ( key == "surgeMax" ) ok = parseValue(text, scenario.surgeMax);
+    else if ( key == "punish" ) ok = parseValue(text, scenario.behavior.punishReject);
+    else if ( key == "punishLimit" )
+      ok = parseValue(text, scenario.behavior.punishRejectLimit);
+    else if ( key == "surge" ) ok = parseValue(text, scenario.behavior.surgePrice);
+    else if ( key == "relocate" ) ok = parseValue(text, scenario.behavior.relocate);
+    else if ( key == "stop" ) ok = parseValue(text, scenario.behavior.stop);
+    else if ( key == "platform" ) ok = parseValue(text, scenario.behavior.platform);
+    else {
+      error = "unknown key: " + key;
+      return false;
+    }
+    if ( !ok ) {
+      error = "bad value: " + token;
+      return false;
+    }
+  }
+  if ( scenario.driverNumber <= 0 ) {
+    error = "drivers must be positive";
+    return false;
+  }
+  if ( scenario.requestNumber <= 0 ) {
+    error = "requests must be positive";
+    return false;
+  }
+  return true;
+}
+
+class Server {
+public:
+  /**
+   * Store shared input, every worker copies the demand generator
+   * @param graph, road graph used instead of table if not NULL
+   * @param cacheBytes, row cache of each worker for the road graph
+   */
+  Server ( const TravelTimeTable & table, const RoadGraph * graph,
+           size_t cacheBytes, const vector<Person> & roster,
+           const DemandGenerator & demand )
+  : table(table), graph(graph), cacheBytes(cacheBytes), roster(roster),
+    demand(demand) {}
+
+  /**
+   * Read scenarios from in until "quit" or the end of input and write
+   * results to out as they finish
+   * @param workerNumber, number of scenarios run at once
+   */
+  void run ( istream & in, ostream & out, int workerNumber ) {
+    this->out = &out;
+    vector<thread> workers;
+    for ( int i = 0; i < workerNumber; i++ )
+      workers.push_back(thread(&Server::work, this));
+
+    string line;
+    while ( getline(in, line) ) {
+      if ( line.find_first_not_of(" \t\r") == string::npos ) continue;
+      if ( line == "quit" ) break;
+      unique_lock<mutex> lock(queueMutex);
+      queue.push_back(line);
+      queueReady.notify_one();
+    }
+
+    {
+      unique_lock<mutex> lock(queueMutex);
+      closed = true;
+    }
+    queueReady.notify_all();
+    for ( int i = 0; i < workers.size(); i++ ) workers[i].join();
+  }
+
+private:
+  const TravelTimeTable & table;
+  const RoadGraph * graph;
+  size_t cacheBytes;
+  const vector<Person> & roster;
+  const DemandGenerator & demand;
+
+  deque<string> queue; // scenario lines not started yet
+  bool closed = false;
+  mutex queueMutex;
+  condition_variable queueReady;
+
+  ostream * out = NULL;
+  mutex outMutex;
+
+  /**
+   * Worker loop, one Center reused for all scenarios of this worker
+   */
+  void work () {
+    unique_ptr<RoadGraphCache> cache;
+    const TravelTimeProvider * network = &table;
+    if ( graph ) {
+      cache.reset(new RoadGraphCache(*graph, cacheBytes));
+      network = cache.get();
+    }
+    Center center(*network, roster, roster.size());
+    DemandGenerator generator(demand);
+
+    while ( true ) {
+      string line;
+      {
+        unique_lock<mutex> lock(queueMutex);
+        while ( queue.empty() && !closed ) queueReady.wait(lock);
+        if ( queue.empty() ) return;
+        line = queue.front();
+        queue.pop_front();
+      }
+
+      Scenario scenario;
+      string error, result;
+      if ( !parseScenario(line, scenario, error) ||
+           !simulate(center, generator, scenario, result, error) )
+        result = "id=" + scenario.id + " error=" + error;
+
+      unique_lock<mutex> lock(outMutex);
+      *out << result << endl;
+    }
+  }
+
+  /**
+   * Run one scenario on a reset Center
+   * @return boolean, false if the request source cannot be used
+   */
+  bool simulate ( Center & center, DemandGenerator & generator,
+                  const Scenario & scenario, string & result, string & error ) {
+    if ( scenario.driverNumber > roster.size() ) {
+      error = "drivers exceeds roster of " + to_string(roster.size());
+      return false;
+    }
+    center.reset(scenario.driverNumber, scenario.behavior);
+
+    long assigned = 0;
+    Param params;
+    if ( scenario.source == "demand" ) {
+      if ( !generator.hasDemand() ) {
+        error = "no demand rates loaded from demand.txt";
+        return false;
+      }
+      generator.reset(scenario.seed);
+      generator.setRequestLimit(scenario.requestNumber);
+      generator.setPlatformMix(scenario.uberShare);
+      generator.setPoolShare(scenario.poolShare);
+      generator.setRatingRange(scenario.ratingMin, scenario.ratingMax);
+      generator.setSurge(scenario.surgeShare, scenario.surgeMin, scenario.surgeMax);
+      while ( generator.next(params) ) {
+        center.assignRequest(params, scenario.driverNumber);
+        assigned++;
+      }
+    } else {
+      ifstream infile(scenario.source);
+      if ( !infile ) {
+        error = "cannot open " + scenario.source;
+        return false;
+      }
+      while ( assigned < scenario.requestNumber && readRequest(infile, params) ) {
+        center.assignRequest(params, scenario.driverNumber);
+        assigned++;
+      }
+    }
+
+    const Metrics & metrics = center.getMetrics();
+    result = "id=" + scenario.id
+    + " drivers=" + to_string(scenario.driverNumber)
+    + " requests=" + to_string(assigned)
+    + " failures=" + to_string(center.getFailureCount())
+    + " accessP50=" + to_string(metrics.getAccessTime(0))
+    + " accessP90=" + to_string(metrics.getAccessTime(1))
+    + " switches=" + to_string(metrics.getTotal().platformSwitches);
+    if ( scenario.printMetrics ) {
+      ostringstream report;
+      metrics.print(report);
+      istringstream lines(report.str());
+      string line;
+      while ( getline(lines, line) )
+        result += "\nid=" + scenario.id + " " + line;
+    }
+    return true;
+  }
+};
+
+/**
+ * Usage: simServer [workers] [roads [cacheMB]]
+ * Reads Traveltime2.txt, drivers.txt and demand.txt once at startup. With
+ * a road graph file, travel times come from the graph instead of
+ * Traveltime2.txt, and each worker keeps cacheMB of shortest path rows.
+ * Zones in demand.txt and drivers.txt get their own metrics, other
+ * nodes share one bucket.
+ */
+int main ( int argc, char * argv[] ) {
+  int workerNumber = thread::hardware_concurrency();
+  if ( argc > 1 ) workerNumber = atoi(argv[1]);
+  if ( workerNumber < 1 ) workerNumber = 1;
+  size_t cacheMegabytes = defaultCacheMegabytes;
+  if ( argc > 3 ) cacheMegabytes = atol(argv[3]);
+
+  TravelTimeTable table;
+  unique_ptr<RoadGraph> graph;
+  if ( argc > 2 ) {
+    ifstream roads(argv[2]);
+    if ( !roads ) {
+      cerr << "cannot open " << argv[2] << endl;
+      return 1;
+    }
+    graph.reset(new RoadGraph(roads));
+    if ( graph->getLinkCount() == 0 ) {
+      cerr << "no links in " << argv[2] << endl;
+      return 1;
+    }
+  } else {
+    ifstream TT("Traveltime2.txt");
+    table = TravelTimeTable(TT);
+    if ( table.getZones().empty() ) {
+      cerr << "no travel times in Traveltime2.txt" << endl;
+      return 1;
+    }
+  }
+  ifstream driver("drivers.txt");
+  vector<Person> roster = readDrivers(driver, INT_MAX);
+  if ( roster.empty() ) {
+    cerr << "no drivers in drivers.txt" << endl;
+    return 1;
+  }
+  // Without demand.txt only scenarios with a requests file can run
+  ifstream rates("demand.txt");
+  DemandGenerator demand(rates, defaultSeed);
+
+  // Per-zone statistics on a road graph cover demand and home zones only
+  if ( graph ) {
+    vector<string> zones = demand.getZones();
+    for ( int i = 0; i < roster.size(); i++ )
+      zones.push_back(roster[i].startZone);
+    graph->setZones(zones);
+  }
+
+  Server server(table, graph.get(), cacheMegabytes << 20, roster, demand);
+  server.run(cin, cout, workerNumber);
+  return 0;
+}